@@ -0,0 +1,133 @@
+/*
+ * Copyright 2026 EDTT bridge contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * Low overhead binary event tracer
+ *
+ * Each event (a call to one of the hot points of the bridge) is recorded
+ * in binary form in a ring buffer: wall clock start and end, simulation time,
+ * device and number of bytes. Nothing is formatted while the simulation runs.
+ * When the bridge exits, the ring buffer content is dumped as a Chrome trace
+ * JSON file, which can be opened in chrome://tracing or Perfetto to see
+ * where each lockstep phase spends wall time.
+ *
+ * The ring buffer keeps only the last BIN_TRACE_N_EVENTS events.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "bs_types.h"
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bin_trace.h"
+
+#define BIN_TRACE_N_EVENTS (1 << 16) //Must be a power of 2
+
+typedef struct {
+  uint64_t wall_start; //ns
+  uint64_t wall_end;   //ns
+  bs_time_t sim_time;
+  uint32_t bytes;
+  int16_t dev; //BIN_TRACE_NO_DEV if not related to a device
+  uint8_t type;
+} bin_trace_event_t;
+
+static bin_trace_event_t events[BIN_TRACE_N_EVENTS];
+static uint64_t n_events;
+static char *file_name = NULL;
+static bs_time_t (*get_sim_time)(void);
+
+static const char *event_names[] = {
+    "edtt_read", "edtt_write", "deviceif_read", "deviceif_write", "phy_wait"
+};
+
+void bin_trace_init(const char *s_id, unsigned int dev_nbr, bs_time_t (*get_time_f)(void)) {
+  get_sim_time = get_time_f;
+  file_name = (char *) bs_calloc(strlen(s_id) + 60, sizeof(char));
+  sprintf(file_name, "bs_device_EDTT_bridge_%s_%u.trace.json", s_id, dev_nbr);
+  n_events = 0;
+}
+
+void bin_trace_record(uint8_t type, uint64_t start, int dev, uint32_t bytes) {
+  bin_trace_event_t *ev = &events[n_events & (BIN_TRACE_N_EVENTS - 1)];
+  ev->wall_end = wall_time_ns();
+  ev->wall_start = start;
+  ev->sim_time = get_sim_time();
+  ev->bytes = bytes;
+  ev->type = type;
+  ev->dev = dev;
+  n_events++;
+}
+
+/*
+ * Timeline lane each event is shown in:
+ * the EDTT link, the phy, and one per device
+ */
+static int event_lane(const bin_trace_event_t *ev) {
+  switch (ev->type) {
+    case BIN_TRACE_EDTT_READ:
+    case BIN_TRACE_EDTT_WRITE:
+      return 1;
+    case BIN_TRACE_PHY_WAIT:
+      return 2;
+    default:
+      return 10 + ev->dev;
+  }
+}
+
+/**
+ * Dump the events in the ring buffer as Chrome trace JSON
+ * (only the first call does anything)
+ */
+void bin_trace_dump(void) {
+  if (file_name == NULL) {
+    return;
+  }
+
+  FILE *file = fopen(file_name, "w");
+  if (file == NULL) {
+    bs_trace_warning_line("Could not open %s to dump the binary trace\n", file_name);
+    free(file_name);
+    file_name = NULL;
+    return;
+  }
+
+  uint64_t first = n_events > BIN_TRACE_N_EVENTS ? n_events - BIN_TRACE_N_EVENTS : 0;
+  uint64_t t0 = n_events > 0 ? events[first & (BIN_TRACE_N_EVENTS - 1)].wall_start : 0;
+
+  fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"EDTT\"}},\n");
+  fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":2,\"args\":{\"name\":\"Phy\"}}");
+
+  bool dev_used[256] = { false };
+  for (uint64_t i = first; i < n_events; i++) {
+    const bin_trace_event_t *ev = &events[i & (BIN_TRACE_N_EVENTS - 1)];
+    if ((event_lane(ev) >= 10) && !dev_used[ev->dev]) {
+      dev_used[ev->dev] = true;
+      fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%i,"
+                    "\"args\":{\"name\":\"Device %i\"}}", event_lane(ev), ev->dev);
+    }
+  }
+  for (uint64_t i = first; i < n_events; i++) {
+    const bin_trace_event_t *ev = &events[i & (BIN_TRACE_N_EVENTS - 1)];
+    fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%i,"
+                  "\"ts\":%.3f,\"dur\":%.3f,"
+                  "\"args\":{\"sim_time\":%"PRItime",\"dev\":%i,\"bytes\":%"PRIu32"}}",
+            event_names[ev->type], event_lane(ev),
+            (ev->wall_start - t0)/1e3, (ev->wall_end - ev->wall_start)/1e3,
+            ev->sim_time, ev->dev, ev->bytes);
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+
+  bs_trace_raw(3, "Binary trace (%"PRIu64" events) dumped to %s\n",
+               n_events - first, file_name);
+  free(file_name);
+  file_name = NULL;
+}
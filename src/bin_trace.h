@@ -0,0 +1,56 @@
+/*
+ * Copyright 2026 EDTT bridge contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EDTT_BIN_TRACE_H
+#define EDTT_BIN_TRACE_H
+
+#include <stdint.h>
+#include "bs_types.h"
+#include "wall_time.h"
+#include "bin_trace_cfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Low overhead binary tracer of the bridge hot points.
+ * Only built when compiling with BIN_TRACE=1, otherwise these macros are empty
+ * (EDTT_BRIDGE_BIN_TRACE is set in the generated bin_trace_cfg.h)
+ */
+
+#define BIN_TRACE_EDTT_READ  0
+#define BIN_TRACE_EDTT_WRITE 1
+#define BIN_TRACE_DEV_READ   2
+#define BIN_TRACE_DEV_WRITE  3
+#define BIN_TRACE_PHY_WAIT   4
+
+#define BIN_TRACE_NO_DEV -1
+
+#if EDTT_BRIDGE_BIN_TRACE
+
+void bin_trace_init(const char *s_id, unsigned int dev_nbr, bs_time_t (*get_time_f)(void));
+void bin_trace_record(uint8_t type, uint64_t start, int dev, uint32_t bytes);
+void bin_trace_dump(void);
+
+#define BIN_TRACE_INIT(s_id, dev_nbr, get_time_f) bin_trace_init(s_id, dev_nbr, get_time_f)
+#define BIN_TRACE_START(start) uint64_t start = wall_time_ns()
+#define BIN_TRACE_END(type, start, dev, bytes) bin_trace_record(type, start, dev, bytes)
+#define BIN_TRACE_DUMP() bin_trace_dump()
+
+#else
+
+#define BIN_TRACE_INIT(s_id, dev_nbr, get_time_f)
+#define BIN_TRACE_START(start)
+#define BIN_TRACE_END(type, start, dev, bytes)
+#define BIN_TRACE_DUMP()
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
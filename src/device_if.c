@@ -35,10 +35,12 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <time.h>
+#include <sys/ioctl.h>
 #include "bs_tracing.h"
 #include "bs_utils.h"
 #include "bs_oswrap.h"
 #include "bs_pc_base_fifo_user.h"
+#include "bin_trace.h"
 
 #define TO_DEVICE  0
 #define TO_BRIDGE 1
@@ -126,9 +128,11 @@ void deviceif_write(uint8_t d, uint8_t* bufptr, size_t size) {
     bs_trace_error_line("device_nbr >= n_devices (%i>= %i)\n", d, n_devices );
   }
 
+  BIN_TRACE_START(trace_start);
   if ( write(FIFOs[d*2 + TO_DEVICE], bufptr, size) != size ){
     bs_trace_error_line("EDTT IF to device %i filled up (FIFO size needs to be increased)\n", simdevice_numbers[d]);
   }
+  BIN_TRACE_END(BIN_TRACE_DEV_WRITE, trace_start, d, size);
 }
 
 /**
@@ -142,6 +146,7 @@ int deviceif_read(uint8_t d, uint8_t* bufptr, size_t size) {
     bs_trace_error_line("device_nbr >= n_devices (%i>= %i)\n", d, n_devices );
   }
 
+  BIN_TRACE_START(trace_start);
   int total_read = 0;
   int pending_to_read = size;
   uint8_t *read_bufptr = bufptr;
@@ -149,7 +154,7 @@ int deviceif_read(uint8_t d, uint8_t* bufptr, size_t size) {
   while ( pending_to_read > 0 ) {
     int received_bytes = read(FIFOs[d*2 + TO_BRIDGE], read_bufptr, pending_to_read);
     if ( ( received_bytes == -1 ) && (errno == EAGAIN) ) { //Nothing yet there
-      return total_read; //whatever we read so far
+      break; //whatever we read so far
     } else if ( received_bytes == EOF ) { //The FIFO was closed by the device
       bs_trace_error_line("DEVICE_IF: device (%i) FIFO closed\n",simdevice_numbers[d]);
     } else if ( received_bytes == -1 ) {
@@ -162,5 +167,22 @@ int deviceif_read(uint8_t d, uint8_t* bufptr, size_t size) {
       total_read += received_bytes;
     }
   }
+  BIN_TRACE_END(BIN_TRACE_DEV_READ, trace_start, d, total_read);
   return total_read;
 }
+
+/**
+ * Return how many bytes device <d> has already written into its EDTT IF
+ * and are pending to be read by us (without consuming them)
+ */
+int deviceif_bytes_available(uint8_t d) {
+  if ( d >= n_devices ) {
+    bs_trace_error_line("device_nbr >= n_devices (%i>= %i)\n", d, n_devices );
+  }
+
+  int available = 0;
+  if ( ioctl(FIFOs[d*2 + TO_BRIDGE], FIONREAD, &available) == -1 ) {
+    bs_trace_error_line("DEVICE_IF: could not check device (%i) FIFO\n",simdevice_numbers[d]);
+  }
+  return available;
+}
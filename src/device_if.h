@@ -16,6 +16,7 @@ void deviceif_connection_clean_up(void);
 void deviceif_connect(uint16_t n_devs, unsigned int dev_nbrs[]);
 void deviceif_write(uint8_t dev_nbr, uint8_t* bufptr, size_t size);
 int deviceif_read(uint8_t dev_nbr, uint8_t* bufptr, size_t size);
+int deviceif_bytes_available(uint8_t dev_nbr);
 
 #ifdef __cplusplus
 }
@@ -91,6 +91,7 @@ void edttbridge_argparse(int argc, char *argv[], edtt_bridge_args_t *args)
       /*manual,mandatory,switch,option,     name ,               type,       destination,         callback,             , description*/
       { false,  false , false, "RxWait",  "recv_wait_us",       'f', (void*)&args->recv_wait_us_f, cmd_recv_wait_found,"(10e3) while there is no enough data for a read, the simulation will be advanced in this steps"},
       { false,  false , true, "AutoTerminate","AutoTerminate",  'b', (void*)&args->terminate_on_edtt_close, NULL,      "Terminate the simulation when EDTT disconnects"},
+      { false,  false , true, "StatusPage","StatusPage",        'b', (void*)&args->status_page, NULL,                 "Publish a live status page (Device<d>.Status) in the simulation com folder"},
       { true ,  true  , false,"dev<nbr>","dev_number",          'u',            NULL,               NULL,              "Simulation device number for the EDTT enable device number <nbr> to connect to"},
       ARG_TABLE_ENDMARKER
   };
@@ -143,6 +144,9 @@ void edttbridge_argparse(int argc, char *argv[], edtt_bridge_args_t *args)
   if (args->nbr_devices == 0){
     bs_trace_error_line("You must provide a number of devices to connect to\n");
   }
+  if (args->nbr_devices > 256){ //The EDTT protocol addresses the devices with 1 byte
+    bs_trace_error_line("At most 256 devices are supported (%i requested)\n", args->nbr_devices);
+  }
   for (int i = 0; i < args->nbr_devices ; i++){
     if (args->EDTT_device_numbers[i] == UINT_MAX){
       bs_trace_error_line("device number %i was not provided\n", i);
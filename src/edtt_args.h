@@ -24,6 +24,7 @@ typedef struct {
   bs_time_t recv_wait_us;
   double recv_wait_us_f;
   int terminate_on_edtt_close;
+  int status_page;
   unsigned int *EDTT_device_numbers;
 } edtt_bridge_args_t;
 
@@ -17,6 +17,7 @@
 #include "bs_pc_base.h"
 #include "bs_pc_base_fifo_user.h"
 #include "edtt_if.h"
+#include "bin_trace.h"
 
 /**
  * Interface towards the EDTT tool
@@ -93,6 +94,7 @@ static void edtt_if_abrupt_exit(){
  * Block until we receive size bytes into buf from the EDTTool
  */
 void edtt_read(uint8_t *buf, size_t size){
+  BIN_TRACE_START(trace_start);
   int pending_to_read = size;
   uint8_t *read_bufptr = buf;
 
@@ -111,12 +113,15 @@ void edtt_read(uint8_t *buf, size_t size){
       read_bufptr +=received_bytes;
     }
   }
+  BIN_TRACE_END(BIN_TRACE_EDTT_READ, trace_start, BIN_TRACE_NO_DEV, size);
   return;
 }
 
 void edtt_write(uint8_t *bufptr, size_t size){
+  BIN_TRACE_START(trace_start);
   if ( write(fifo[TO_EDTT], bufptr, size) != size ){
     //the other end of the pipe was closed
     edtt_if_abrupt_exit();
   }
+  BIN_TRACE_END(BIN_TRACE_EDTT_WRITE, trace_start, BIN_TRACE_NO_DEV, size);
 }
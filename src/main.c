@@ -5,9 +5,13 @@
  */
 #include <string.h>
 #include "bs_tracing.h"
+#include "bs_oswrap.h"
 #include "edtt_args.h"
 #include "edtt_if.h"
 #include "device_if.h"
+#include "status_page.h"
+#include "bin_trace.h"
+#include "wall_time.h"
 #include "bs_pc_base.h"
 
 /**
@@ -20,6 +24,7 @@
  *   it wants next
  * * It pipes the send and recv requests from the EDTTool to the devices
  *  * Send requests are sent in no time to the devices
+ *  * Send multi requests are sent in no time to several devices at once
  *  * Receive requests:
  *    * Are done in no time if the data is already available. If it is not, the
  *      simulation will be advanced <recv_wait_us> ms at a time until the device
@@ -31,8 +36,22 @@
  *  * Receive with wait notify requests:
  *    * Same as normal receive requests, except that whenever the bridge waits it
  *      will first notify the EDTT bridge via a wait notification message
+ *    * In its extended version, the notifications are throttled (only the first,
+ *      every Nth and/or after a minimum simulated time) and also report how
+ *      many bytes have been received so far
  * * It handles the wait requests from the EDTT driver by letting the simulation
  *   advance by that amount of time
+ *  * Wait with status/data requests:
+ *    * Once the wait is done, the current time and how much data each device
+ *      has available (or the data itself) is piggybacked in the reply, so the
+ *      EDTT does not need to poll each device afterwards
+ * * It answers echo requests immediately with the wall clock time in which the
+ *   request was received and the reply sent, so the EDTT can measure the
+ *   transport latency. The echo probe variant also times a zero length wait in
+ *   the phy (scheduler wait grant latency)
+ * * Optionally, it publishes a live status page (current time, command being
+ *   processed, wait and per-device byte counters) in the simulation com folder,
+ *   which the EDTT or external monitors can map to follow the bridge progress
  *
  * Effectively it either blocks the simulator or the EDTTool so that only one
  * executes at a time, locksteping them to ensure that simulations are fully
@@ -52,6 +71,8 @@ static bs_time_t read_wait_time;
 pb_dev_state_t state;
 
 uint8_t main_clean_up() {
+  BIN_TRACE_DUMP();
+  status_page_clean_up();
   edtt_if_clean_up();
   deviceif_connection_clean_up();
   pb_dev_terminate(&state);
@@ -62,6 +83,64 @@ uint8_t main_clean_up() {
   return 0;
 }
 
+/**
+ * Reply to a WAIT_WSTATUS: the current time and how many bytes each
+ * device has available, so the EDTT does not need to poll each of them
+ */
+static void reply_wait_status(void) {
+  unsigned int n_devs = args.nbr_devices;
+  uint8_t reply[1 + sizeof(bs_time_t) + n_devs*sizeof(uint32_t)];
+  uint8_t *ptr = reply;
+
+  *ptr++ = 0;
+  memcpy(ptr, &Now, sizeof(bs_time_t));
+  ptr += sizeof(bs_time_t);
+  for (unsigned int d = 0; d < n_devs; d++) {
+    uint32_t count = deviceif_bytes_available(d);
+    memcpy(ptr, &count, sizeof(count));
+    ptr += sizeof(count);
+  }
+  bs_trace_raw_time(9, "main: Replying wait status for %i devices\n", n_devs);
+  edtt_write(reply, sizeof(reply));
+}
+
+/**
+ * Reply to a WAIT_WDATA: the current time and whatever data (up to
+ * <max_bytes>) each device has available
+ * The reply buffer is sized for what the devices actually have for us,
+ * and sent in one go
+ */
+static void reply_wait_data(uint16_t max_bytes) {
+  unsigned int n_devs = args.nbr_devices;
+  uint16_t to_read[n_devs];
+  size_t reply_size = 1 + sizeof(bs_time_t);
+
+  for (unsigned int d = 0; d < n_devs; d++) {
+    int available = deviceif_bytes_available(d);
+    to_read[d] = available > max_bytes ? max_bytes : available;
+    reply_size += sizeof(uint16_t) + to_read[d];
+  }
+
+  uint8_t *reply = (uint8_t *) bs_malloc(reply_size);
+  uint8_t *ptr = reply;
+
+  *ptr++ = 0;
+  memcpy(ptr, &Now, sizeof(bs_time_t));
+  ptr += sizeof(bs_time_t);
+  for (unsigned int d = 0; d < n_devs; d++) {
+    uint16_t count = 0;
+    if (to_read[d] > 0) {
+      count = deviceif_read(d, ptr + sizeof(count), to_read[d]);
+      status_page_dev_bytes(d, 0, count);
+    }
+    memcpy(ptr, &count, sizeof(count));
+    ptr += sizeof(count) + count;
+  }
+  bs_trace_raw_time(9, "main: Replying wait data for %i devices\n", n_devs);
+  edtt_write(reply, ptr - reply);
+  free(reply);
+}
+
 int receive_and_process_command_from_edtt(){
   /*
    * The protocol with the EDTTool is as follows:
@@ -71,6 +150,11 @@ int receive_and_process_command_from_edtt(){
    *    1 byte : device idx
    *    2 bytes: (uint16_t) number of bytes
    *    N bytes: payload to forward
+   *  SEND_MULTI is followed by:
+   *    1 byte : number of devices (K), 0 means all devices
+   *    K bytes: device idxs
+   *    2 bytes: (uint16_t) number of bytes
+   *    N bytes: payload to forward to all those devices
    *  RCV is followed by:
    *    1 byte : device idx
    *    8 bytes: timeout time (simulated absolute time)
@@ -79,12 +163,24 @@ int receive_and_process_command_from_edtt(){
    *    1 byte : device idx
    *    8 bytes: timeout time (simulated absolute time)
    *    2 bytes: (uint16_t) number of bytes
-   *  WAIT & WAIT_WRESP:
+   *  RCV_WAIT_NOTIFY_EXT is followed by:
+   *    1 byte : device idx
+   *    8 bytes: timeout time (simulated absolute time)
+   *    2 bytes: (uint16_t) number of bytes
+   *    2 bytes: (uint16_t) notify every this many waits (0 = only on the first one)
+   *    8 bytes: (uint64_t) minimum simulated time between notifications
+   *  WAIT & WAIT_WRESP & WAIT_WSTATUS:
    *    8 bytes: (uint64_t) absolute time stamp until which to wait (not the wait duration, but the end of the wait)
+   *  WAIT_WDATA:
+   *    8 bytes: (uint64_t) absolute time stamp until which to wait (not the wait duration, but the end of the wait)
+   *    2 bytes: (uint16_t) maximum number of bytes to read from each device
+   *  ECHO: nothing
+   *  ECHO_PROBE: nothing
    *  DISCONNECT: nothing
    *
    *  After receiving a command (and its payload) this bridge device will respond:
    *  to a SEND: nothing
+   *  to a SEND_MULTI: nothing
    *  to a RCV:
    *    1 byte : reception done (0) or timeout (1)
    *    8 bytes: timestamp when the reception or timeout actually happened
@@ -96,9 +192,32 @@ int receive_and_process_command_from_edtt(){
    *      1 byte : reception done (0) or timeout (1)
    *      8 bytes: timestamp when the reception or timeout actually happened
    *      0/N bytes: (0 bytes if timeout, N bytes as requested otherwise)
+   *  to a RCV_WAIT_NOTIFY_EXT:
+   *    Same as RCV_WAIT_NOTIFY, but a WAIT_NOTIFICATION_EXT is only sent on the
+   *    first wait, and then every N waits, as long as the minimum time since
+   *    the previous notification has passed. Each WAIT_NOTIFICATION_EXT is followed by:
+   *      8 bytes: (uint64_t) absolute time stamp until which the wait will run
+   *      2 bytes: (uint16_t) number of bytes received so far
    *  to a WAIT: nothing
    *  to a WAIT_WRESP:
    *      1 byte (0) when wait is done
+   *  to a WAIT_WSTATUS, when the wait is done:
+   *      1 byte (0)
+   *      8 bytes: current simulation time
+   *      for each device: 4 bytes (uint32_t) number of bytes the device has available for reception
+   *  to a WAIT_WDATA, when the wait is done:
+   *      1 byte (0)
+   *      8 bytes: current simulation time
+   *      for each device:
+   *        2 bytes: (uint16_t) number of bytes read from the device (M, up to the requested maximum)
+   *        M bytes: data read from the device (it is consumed, so a later RCV will not get it again)
+   *  to an ECHO, immediately:
+   *      8 bytes: (uint64_t) wall clock time (ns, CLOCK_MONOTONIC) when the command was received
+   *      8 bytes: (uint64_t) wall clock time (ns, CLOCK_MONOTONIC) when the reply was sent
+   *  to an ECHO_PROBE, after doing a zero length wait in the phy:
+   *      8 bytes: (uint64_t) wall clock time (ns) when the command was received
+   *      8 bytes: (uint64_t) wall clock time (ns) when the phy wait was granted
+   *               (the reply is sent right after)
    *  to a DISCONNECT: nothing
    *  to an unknown command: UNKNOWN_COMMAND
    *
@@ -109,14 +228,22 @@ int receive_and_process_command_from_edtt(){
 #define SEND 2
 #define RCV  3
 #define RCV_WAIT_NOTIFY 4
+#define WAIT_WSTATUS 6
+#define WAIT_WDATA 7
+#define ECHO 8
+#define ECHO_PROBE 9
+#define SEND_MULTI 10
+#define RCV_WAIT_NOTIFY_EXT 11
 
 #define WAIT_NOTIFICATION 0xF0
+#define WAIT_NOTIFICATION_EXT 0xF1
 #define UNKNOWN_COMMAND 0xFF
 
   uint8_t command = DISCONNECT;
 
   bs_trace_raw_time(9, "main: Awaiting EDTTool command\n");
   edtt_read(&command, 1);
+  status_page_command_start(command, Now);
   switch (command) {
     case DISCONNECT:
     { //End the simulation
@@ -129,14 +256,23 @@ int receive_and_process_command_from_edtt(){
     }
     case WAIT:
     case WAIT_WRESP:
+    case WAIT_WSTATUS:
+    case WAIT_WDATA:
     { //Let the simulator run until this time is reached
       pb_wait_t wait_s; //64bits = 8bytes
+      uint16_t max_bytes = 0;
       edtt_read((uint8_t*)&wait_s.end, sizeof(wait_s.end));
+      if (command == WAIT_WDATA) {
+        edtt_read((uint8_t*)&max_bytes, sizeof(max_bytes));
+      }
       bs_trace_raw_time(8, "main: EDTT asked to wait for  %"PRItime"us\n", wait_s.end);
       if (wait_s.end > Now) {
+        BIN_TRACE_START(trace_start);
         if (pb_dev_request_wait_block(&state, &wait_s) != 0) {
           bs_trace_exit_line("Scheduler killed us while running a Wait\n");
         }
+        BIN_TRACE_END(BIN_TRACE_PHY_WAIT, trace_start, BIN_TRACE_NO_DEV, 0);
+        status_page_wait_done(wait_s.end, wait_s.end - Now);
         Now = wait_s.end;
       } else {
         bs_trace_warning_manual_time_line(Now,"Wait into the past (%"PRItime") ignored\n", wait_s.end);
@@ -144,6 +280,10 @@ int receive_and_process_command_from_edtt(){
       if (command == WAIT_WRESP) {
         uint8_t reply = 0;
         edtt_write(&reply, 1);
+      } else if (command == WAIT_WSTATUS) {
+        reply_wait_status();
+      } else if (command == WAIT_WDATA) {
+        reply_wait_data(max_bytes);
       }
       break;
     }
@@ -158,23 +298,62 @@ int receive_and_process_command_from_edtt(){
         edtt_read(buffer, number_of_bytes);
         bs_trace_raw_time(8, "main: (%i) EDTT asked to send %i bytes\n",device_idx, number_of_bytes);
         deviceif_write(device_idx, buffer, number_of_bytes);
+        status_page_dev_bytes(device_idx, number_of_bytes, 0);
+      }
+      break;
+    }
+    case SEND_MULTI:
+    { //Forward the same message without delay to several devices
+      uint8_t n_idxs;
+      uint16_t number_of_bytes = 0;
+      edtt_read(&n_idxs, sizeof(n_idxs));
+      uint8_t device_idxs[n_idxs > 0 ? n_idxs : 1];
+      if (n_idxs > 0) {
+        edtt_read(device_idxs, n_idxs);
+      }
+      edtt_read((uint8_t*)&number_of_bytes, sizeof(number_of_bytes));
+      if (number_of_bytes > 0) {
+        uint8_t buffer[number_of_bytes];
+        edtt_read(buffer, number_of_bytes);
+        if (n_idxs > 0) {
+          bs_trace_raw_time(8, "main: EDTT asked to send %i bytes to %i devices\n", number_of_bytes, n_idxs);
+          for (unsigned int i = 0; i < n_idxs; i++) {
+            deviceif_write(device_idxs[i], buffer, number_of_bytes);
+            status_page_dev_bytes(device_idxs[i], number_of_bytes, 0);
+          }
+        } else {
+          bs_trace_raw_time(8, "main: EDTT asked to send %i bytes to all devices\n", number_of_bytes);
+          for (unsigned int d = 0; d < args.nbr_devices; d++) {
+            deviceif_write(d, buffer, number_of_bytes);
+            status_page_dev_bytes(d, number_of_bytes, 0);
+          }
+        }
       }
       break;
     }
     case RCV:
     case RCV_WAIT_NOTIFY:
+    case RCV_WAIT_NOTIFY_EXT:
     {
       uint8_t device_idx;
       uint16_t number_of_bytes = 0;
       bs_time_t timeout;
+      uint16_t notify_every = 1;
+      bs_time_t notify_min_interval = 0;
       edtt_read(&device_idx, sizeof(device_idx));
       edtt_read((uint8_t*)&timeout, sizeof(bs_time_t));
       edtt_read((uint8_t*)&number_of_bytes, sizeof(number_of_bytes));
+      if (command == RCV_WAIT_NOTIFY_EXT) {
+        edtt_read((uint8_t*)&notify_every, sizeof(notify_every));
+        edtt_read((uint8_t*)&notify_min_interval, sizeof(notify_min_interval));
+      }
       bs_trace_raw_time(8, "main: (%i) EDTT asked to rcv %i bytes with timeout @%"PRItime"\n",device_idx, number_of_bytes, timeout);
       uint8_t buffer_m[number_of_bytes + 9];
       uint8_t *buffer = buffer_m + 9;
       int pending_to_read = number_of_bytes;
       uint16_t readsofar = 0;
+      unsigned int n_waits = 0;
+      bs_time_t last_notify = 0;
       while (Now < timeout) {
         int read = deviceif_read(device_idx, &buffer[readsofar], pending_to_read);
         pending_to_read -= read;
@@ -188,11 +367,25 @@ int receive_and_process_command_from_edtt(){
             notify_buffer[0] = WAIT_NOTIFICATION;
             memcpy(&notify_buffer[1], &Wait_struct.end, sizeof(Wait_struct.end));
             edtt_write(notify_buffer, sizeof(notify_buffer));
+          } else if ((command == RCV_WAIT_NOTIFY_EXT)
+                     && ((n_waits == 0)
+                         || ((notify_every > 0) && (n_waits % notify_every == 0)
+                             && (Now - last_notify >= notify_min_interval)))) {
+            uint8_t notify_buffer[1 + sizeof(bs_time_t) + sizeof(readsofar)];
+            notify_buffer[0] = WAIT_NOTIFICATION_EXT;
+            memcpy(&notify_buffer[1], &Wait_struct.end, sizeof(Wait_struct.end));
+            memcpy(&notify_buffer[1 + sizeof(bs_time_t)], &readsofar, sizeof(readsofar));
+            edtt_write(notify_buffer, sizeof(notify_buffer));
+            last_notify = Now;
           }
+          n_waits++;
+          BIN_TRACE_START(trace_start);
           if ( pb_dev_request_wait_block(&state, &Wait_struct) != 0 ) {
             bs_trace_exit_line("Disconnected by Phy during wait\n");
           }
+          BIN_TRACE_END(BIN_TRACE_PHY_WAIT, trace_start, device_idx, 0);
           //bs_trace_raw_time(9, "main: Not enough data, waiting\t");
+          status_page_wait_done(Wait_struct.end, read_wait_time);
           Now += read_wait_time;
         } else { //if pending_to_read > 0
           break;
@@ -200,6 +393,7 @@ int receive_and_process_command_from_edtt(){
       }
       uint8_t *message = buffer_m;
       memcpy(&message[1], &Now, sizeof(bs_time_t));
+      status_page_dev_bytes(device_idx, 0, readsofar);
 
       if (pending_to_read == 0) { //succeeded
         bs_trace_raw_time(9, "main: (%i) All %i bytes received forwarding\n",device_idx, number_of_bytes);
@@ -212,6 +406,31 @@ int receive_and_process_command_from_edtt(){
       }
       break;
     }
+    case ECHO:
+    { //Reply immediately, so the EDTT can measure the transport latency
+      uint64_t timestamps[2];
+      timestamps[0] = wall_time_ns();
+      timestamps[1] = wall_time_ns();
+      edtt_write((uint8_t*)timestamps, sizeof(timestamps));
+      bs_trace_raw_time(8, "main: EDTT asked for an echo\n");
+      break;
+    }
+    case ECHO_PROBE:
+    { //Time separately the round-trip to the phy
+      uint64_t timestamps[2];
+      timestamps[0] = wall_time_ns();
+      pb_wait_t wait_s;
+      wait_s.end = Now; //Zero length wait: only the scheduler grant latency
+      BIN_TRACE_START(trace_start);
+      if (pb_dev_request_wait_block(&state, &wait_s) != 0) {
+        bs_trace_exit_line("Scheduler killed us while running an echo probe\n");
+      }
+      timestamps[1] = wall_time_ns();
+      BIN_TRACE_END(BIN_TRACE_PHY_WAIT, trace_start, BIN_TRACE_NO_DEV, 0);
+      edtt_write((uint8_t*)timestamps, sizeof(timestamps));
+      bs_trace_raw_time(8, "main: EDTT asked for an echo probe\n");
+      break;
+    }
     default:
     {
       uint8_t reply = UNKNOWN_COMMAND;
@@ -223,6 +442,7 @@ int receive_and_process_command_from_edtt(){
     }
   }
 
+  status_page_command_done(Now);
   return 0;
 }
 
@@ -243,6 +463,7 @@ int main(int argc, char *argv[]) {
   edttbridge_argparse(argc, argv, &args);
   terminate_on_edtt_close = args.terminate_on_edtt_close;
   read_wait_time = args.recv_wait_us;
+  BIN_TRACE_INIT(args.s_id, args.global_device_nbr, get_time);
 
   bs_trace_raw(9,"main: Connecting to scheduler...\n");
   pb_dev_init_com(&state, args.device_nbr, args.s_id, args.p_id);
@@ -250,6 +471,10 @@ int main(int argc, char *argv[]) {
   bs_trace_raw(9,"main: Connecting to devices...\n");
   deviceif_connect(args.nbr_devices, args.EDTT_device_numbers);
 
+  if (args.status_page) {
+    status_page_open(args.global_device_nbr, args.nbr_devices);
+  }
+
   bs_trace_raw(9,"main: Connecting to EDTT (Embedded Device Test Tool)...\n");
   edtt_if_connect(args.global_device_nbr, args.terminate_on_edtt_close, args.nbr_devices);
   bs_trace_raw(9,"main: Connected\n");
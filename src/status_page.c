@@ -0,0 +1,124 @@
+/*
+ * Copyright 2026 EDTT bridge contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * Live status page of the bridge
+ *
+ * A small file in the simulation com folder, mapped in memory, where the
+ * bridge publishes its current simulation time, what it is doing and some
+ * counters. The EDTT or any external monitor can map it read only and
+ * follow the bridge progress without any syscall or protocol round-trip.
+ *
+ * There is only one writer (this bridge) which updates the page seqlock style:
+ * seq is odd while an update is ongoing.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include "bs_tracing.h"
+#include "bs_oswrap.h"
+#include "bs_pc_base_fifo_user.h"
+#include "status_page.h"
+
+static status_page_t *page = NULL;
+static size_t page_size;
+static char *page_path = NULL;
+
+void status_page_open(unsigned int dev_nbr, uint16_t n_devs) {
+  int fd;
+
+  page_size = sizeof(status_page_t) + n_devs*sizeof(status_page_dev_t);
+  page_path = (char*) bs_calloc(pb_com_path_length + 30, sizeof(char));
+  sprintf(page_path, "%s/Device%i.Status", pb_com_path, dev_nbr);
+
+  if ((fd = open(page_path, O_RDWR | O_CREAT | O_TRUNC, 0644)) == -1) {
+    bs_trace_error_line("Could not create status page %s\n", page_path);
+  }
+  if (ftruncate(fd, page_size) != 0) {
+    bs_trace_error_line("Could not size status page %s\n", page_path);
+  }
+  page = (status_page_t *) mmap(NULL, page_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (page == MAP_FAILED) {
+    page = NULL;
+    bs_trace_error_line("Could not map status page %s\n", page_path);
+  }
+
+  memset(page, 0, page_size);
+  page->version = STATUS_PAGE_VERSION;
+  page->n_devices = n_devs;
+  //The magic is set last, so readers know when the page is valid
+  __atomic_store_n(&page->magic, STATUS_PAGE_MAGIC, __ATOMIC_RELEASE);
+}
+
+void status_page_clean_up(void) {
+  if (page != NULL) {
+    munmap(page, page_size);
+    page = NULL;
+  }
+  if (page_path != NULL) {
+    remove(page_path);
+    free(page_path);
+    page_path = NULL;
+  }
+}
+
+static inline void update_start(void) {
+  __atomic_store_n(&page->seq, page->seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void update_end(void) {
+  __atomic_store_n(&page->seq, page->seq + 1, __ATOMIC_RELEASE);
+}
+
+void status_page_command_start(uint8_t command, bs_time_t now) {
+  if (page == NULL) {
+    return;
+  }
+  update_start();
+  page->busy = 1;
+  page->command = command;
+  page->now = now;
+  page->n_commands++;
+  update_end();
+}
+
+void status_page_command_done(bs_time_t now) {
+  if (page == NULL) {
+    return;
+  }
+  update_start();
+  page->busy = 0;
+  page->now = now;
+  update_end();
+}
+
+void status_page_wait_done(bs_time_t now, bs_time_t waited) {
+  if (page == NULL) {
+    return;
+  }
+  update_start();
+  page->now = now;
+  page->n_waits++;
+  page->waited_time += waited;
+  update_end();
+}
+
+void status_page_dev_bytes(uint8_t dev, uint32_t to_device, uint32_t from_device) {
+  if ((page == NULL) || (dev >= page->n_devices)) {
+    return;
+  }
+  update_start();
+  page->dev[dev].bytes_to_device += to_device;
+  page->dev[dev].bytes_from_device += from_device;
+  update_end();
+}
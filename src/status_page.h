@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026 EDTT bridge contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EDTT_STATUS_PAGE_H
+#define EDTT_STATUS_PAGE_H
+
+#include <stdint.h>
+#include "bs_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STATUS_PAGE_MAGIC   0x42544445 //"EDTB" in little endian
+#define STATUS_PAGE_VERSION 1
+
+typedef struct {
+  uint64_t bytes_to_device;
+  uint64_t bytes_from_device;
+} status_page_dev_t;
+
+/*
+ * Layout of the status page as seen by the readers.
+ * Readers must read seq, copy the page, and read seq again; the copy is only
+ * consistent if both seq reads match and are even
+ */
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t n_devices;
+  uint32_t seq;
+  uint8_t  busy;     //1 while processing an EDTT command, 0 while waiting for the EDTT
+  uint8_t  command;  //last (or current if busy) command received from the EDTT
+  uint8_t  pad[2];
+  uint64_t now;          //current simulation time
+  uint64_t n_commands;   //number of commands received from the EDTT
+  uint64_t n_waits;      //number of waits requested to the phy
+  uint64_t waited_time;  //total simulated time spent waiting
+  status_page_dev_t dev[];
+} status_page_t;
+
+void status_page_open(unsigned int dev_nbr, uint16_t n_devs);
+void status_page_clean_up(void);
+void status_page_command_start(uint8_t command, bs_time_t now);
+void status_page_command_done(bs_time_t now);
+void status_page_wait_done(bs_time_t now, bs_time_t waited);
+void status_page_dev_bytes(uint8_t dev, uint32_t to_device, uint32_t from_device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
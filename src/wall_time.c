@@ -0,0 +1,19 @@
+/*
+ * Copyright 2026 EDTT bridge contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <time.h>
+#include "wall_time.h"
+
+/**
+ * Wall clock time in ns
+ * CLOCK_MONOTONIC is used so it can be compared with timestamps taken by
+ * other processes in the same host (like the EDTT)
+ */
+uint64_t wall_time_ns(void) {
+  struct timespec tv;
+  clock_gettime(CLOCK_MONOTONIC, &tv);
+  return (uint64_t)tv.tv_sec * 1000000000ULL + tv.tv_nsec;
+}
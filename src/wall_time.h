@@ -0,0 +1,21 @@
+/*
+ * Copyright 2026 EDTT bridge contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EDTT_WALL_TIME_H
+#define EDTT_WALL_TIME_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t wall_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif